@@ -26,6 +26,7 @@
 #if USE_DEBUG_BLEACH_NEW
 
 #include <crtdbg.h>
+#include <cstring>
 
 //---------------------------------------------------------------------------------------------------------------------
 // Memory debugging.  We maintain two hash maps, one for all the records keyed by address and one to keep track of 
@@ -44,6 +45,10 @@
 #if ENABLE_BLEACH_ALLOCATION_TRACKING
     #include <mutex>
     #include <atomic>
+    #include <new>
+    #include <cstdlib>
+    #include <cerrno>
+    #include <exception>
 
     #if BLEACH_NEW_USE_EASTL
         #include <EASTL/hash_map.h>
@@ -86,36 +91,210 @@
     namespace BleachNewInternal
     {
         //-----------------------------------------------------------------------------------------------------------------
-        // Raw Allocator for EASTL
+        // Arena that backs all of the memory debugger's internal storage.  Memory comes straight from VirtualAlloc() so 
+        // it never touches the CRT debug heap, and Release() hands every chunk back at once without visiting any of the 
+        // records.  Small blocks (hash map nodes and filenames) are recycled through free lists bucketed by size so a 
+        // long running process doesn't keep growing.  Large blocks (bucket arrays) are only reclaimed by Release(), 
+        // which is one more reason to presize the maps.
+        // 
+        // The arena has no locking of its own.  It's only ever touched while the MemoryDebugger's mutex is held.
+        //-----------------------------------------------------------------------------------------------------------------
+        class TrackerArena
+        {
+            struct Chunk
+            {
+                Chunk* pNext;
+                size_t size;
+            };
+
+            struct FreeBlock
+            {
+                FreeBlock* pNext;
+            };
+
+            static constexpr size_t kAlignment = 16;
+            static constexpr size_t kMaxPooledSize = 256;
+            static constexpr size_t kNumPools = kMaxPooledSize / kAlignment;
+            static constexpr size_t kMinChunkSize = 64 * 1024;
+            static constexpr size_t kMaxAllocationSize = SIZE_MAX / 2;  // anything bigger is a bogus request
+
+            Chunk* m_pChunks;
+            char* m_pCurrent;
+            char* m_pEnd;
+            FreeBlock* m_pools[kNumPools];
+            size_t m_nextChunkSize;
+            size_t m_bytesReserved;
+            size_t m_highWaterBytes;  // bytes ever carved out of the chunks; blocks reused from the free lists aren't counted again
+            uint64_t m_growthCount;
+
+        public:
+            // There's deliberately no constructor.  The global instance is zero initialized before any dynamic 
+            // initializers run, so it's safe no matter when the first allocation happens.
+            bool Init(size_t initialSize)
+            {
+                Release();
+                m_nextChunkSize = (initialSize > kMinChunkSize) ? initialSize : kMinChunkSize;
+                return AddChunk(0);
+            }
+
+            void* Allocate(size_t size)
+            {
+                if (size > kMaxAllocationSize)
+                    return nullptr;
+
+                size = RoundUp(size);
+                if (size <= kMaxPooledSize)
+                {
+                    FreeBlock*& pHead = m_pools[size / kAlignment - 1];
+                    if (pHead)
+                    {
+                        FreeBlock* pBlock = pHead;
+                        pHead = pBlock->pNext;
+                        return pBlock;
+                    }
+                }
+
+                if (size > static_cast<size_t>(m_pEnd - m_pCurrent))
+                {
+                    if (!AddChunk(size))
+                        return nullptr;
+                    ++m_growthCount;
+                }
+
+                void* pPtr = m_pCurrent;
+                m_pCurrent += size;
+                m_highWaterBytes += size;
+                return pPtr;
+            }
+
+            void Free(void* pPtr, size_t size)
+            {
+                size = RoundUp(size);
+                if (!pPtr || size > kMaxPooledSize)
+                    return;
+
+                FreeBlock*& pHead = m_pools[size / kAlignment - 1];
+                FreeBlock* pBlock = static_cast<FreeBlock*>(pPtr);
+                pBlock->pNext = pHead;
+                pHead = pBlock;
+            }
+
+            // Frees everything the arena has ever handed out.  Nothing allocated from it may be used afterwards.
+            void Release()
+            {
+                Chunk* pChunk = m_pChunks;
+                while (pChunk)
+                {
+                    Chunk* pNext = pChunk->pNext;
+                    ::VirtualFree(pChunk, 0, MEM_RELEASE);
+                    pChunk = pNext;
+                }
+                std::memset(this, 0, sizeof(*this));
+            }
+
+            uint64_t GetGrowthCount() const { return m_growthCount; }
+            size_t GetBytesReserved() const { return m_bytesReserved; }
+            size_t GetHighWaterBytes() const { return m_highWaterBytes; }
+
+        private:
+            static size_t RoundUp(size_t size) { return (size > 0) ? (size + kAlignment - 1) & ~(kAlignment - 1) : kAlignment; }
+
+            bool AddChunk(size_t minSize)
+            {
+                const size_t headerSize = RoundUp(sizeof(Chunk));
+                const size_t chunkSize = (m_nextChunkSize > minSize + headerSize) ? m_nextChunkSize : minSize + headerSize;
+
+                void* pMemory = ::VirtualAlloc(nullptr, chunkSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+                if (!pMemory)
+                    return false;
+
+                Chunk* pChunk = static_cast<Chunk*>(pMemory);
+                pChunk->pNext = m_pChunks;
+                pChunk->size = chunkSize;
+                m_pChunks = pChunk;
+
+                m_pCurrent = static_cast<char*>(pMemory) + headerSize;
+                m_pEnd = static_cast<char*>(pMemory) + chunkSize;
+                m_bytesReserved += chunkSize;
+                m_nextChunkSize = (chunkSize > SIZE_MAX / 2) ? chunkSize : chunkSize * 2;  // saturate rather than wrap
+                return true;
+            }
+        };
+
+        //---------------------------------------------------------------------------------------------------------------------
+        // The one and only tracker arena.
+        //---------------------------------------------------------------------------------------------------------------------
+        static TrackerArena g_trackerArena;
+
+        //-----------------------------------------------------------------------------------------------------------------
+        // Arena Allocators
         //-----------------------------------------------------------------------------------------------------------------
         #if BLEACH_NEW_USE_EASTL
-            class RawEastlAllocator
+            class ArenaEastlAllocator
             {
                 const char* m_pName;
 
             public:
-                RawEastlAllocator(const char* name = "Raw EASTL") : m_pName(name) {}
-                RawEastlAllocator(const RawEastlAllocator&) = default;
-                RawEastlAllocator([[maybe_unused]] const RawEastlAllocator& x, const char* name) : RawEastlAllocator(name) {}
-                RawEastlAllocator& operator=(const RawEastlAllocator&) = default;
+                ArenaEastlAllocator(const char* name = "Bleach Arena EASTL") : m_pName(name) {}
+                ArenaEastlAllocator(const ArenaEastlAllocator&) = default;
+                ArenaEastlAllocator([[maybe_unused]] const ArenaEastlAllocator& x, const char* name) : ArenaEastlAllocator(name) {}
+                ArenaEastlAllocator& operator=(const ArenaEastlAllocator&) = default;
+
+                // EASTL doesn't check for null, so fail the same way ArenaStlAllocator does.
+                void* allocate(size_t n, [[maybe_unused]] int flags = 0)
+                {
+                    void* pPtr = g_trackerArena.Allocate(n);
+                    if (!pPtr)
+                        throw std::bad_alloc();
+                    return pPtr;
+                }
 
-                void* allocate(size_t n, [[maybe_unused]] int flags = 0) { return ::operator new(n); }
                 void* allocate(size_t n, [[maybe_unused]] size_t alignment, [[maybe_unused]] size_t offset, [[maybe_unused]] int flags = 0) { return allocate(n); }
-                void  deallocate(void* p, size_t n) { ::operator delete(p, n); }
+                void  deallocate(void* p, size_t n) { g_trackerArena.Free(p, n); }
 
                 const char* get_name() const { return m_pName; }
                 void        set_name(const char* name) { m_pName = name; }
             };
 
-            // All RawEastlAllocator's are totally interchangeable.
-            inline bool operator==([[maybe_unused]] const RawEastlAllocator& a, [[maybe_unused]] const RawEastlAllocator& b) { return true; }
-            inline bool operator!=([[maybe_unused]] const RawEastlAllocator& a, [[maybe_unused]] const RawEastlAllocator& b) { return false; }
+            // All ArenaEastlAllocator's are totally interchangeable.
+            inline bool operator==([[maybe_unused]] const ArenaEastlAllocator& a, [[maybe_unused]] const ArenaEastlAllocator& b) { return true; }
+            inline bool operator!=([[maybe_unused]] const ArenaEastlAllocator& a, [[maybe_unused]] const ArenaEastlAllocator& b) { return false; }
 
             // container aliases
-            using Filename = eastl::basic_string<char, RawEastlAllocator>;
+            using Filename = eastl::basic_string<char, ArenaEastlAllocator>;
             using StringHasher = eastl::hash<const char*>;
         #else
-            using Filename = std::string;
+            template <class Type>
+            class ArenaStlAllocator
+            {
+            public:
+                using value_type = Type;
+
+                ArenaStlAllocator() = default;
+                template <class Other> ArenaStlAllocator(const ArenaStlAllocator<Other>&) {}
+
+                Type* allocate(size_t n)
+                {
+                    if (n > SIZE_MAX / sizeof(Type))
+                        throw std::bad_alloc();
+
+                    void* pPtr = g_trackerArena.Allocate(n * sizeof(Type));
+                    if (!pPtr)
+                        throw std::bad_alloc();
+                    return static_cast<Type*>(pPtr);
+                }
+
+                void deallocate(Type* p, size_t n) { g_trackerArena.Free(p, n * sizeof(Type)); }
+            };
+
+            // All ArenaStlAllocator's are totally interchangeable.
+            template <class Left, class Right>
+            inline bool operator==(const ArenaStlAllocator<Left>&, const ArenaStlAllocator<Right>&) { return true; }
+            template <class Left, class Right>
+            inline bool operator!=(const ArenaStlAllocator<Left>&, const ArenaStlAllocator<Right>&) { return false; }
+
+            // container aliases
+            using Filename = std::basic_string<char, std::char_traits<char>, ArenaStlAllocator<char>>;
             using StringHasher = std::hash<const char*>;
         #endif  // BLEACH_NEW_USE_EASTL
 
@@ -129,10 +308,12 @@
                 uint64_t id;  // unique ID per allocation which is incrementally updated
                 uint32_t allocLocationHash;  // hash of location and line number to serve as a unique allocation point
                 void* pAddress;  // the address of the returned allocation
+                size_t size;  // size of the allocation in bytes, updated when it's resized in place
 
-                MemoryRecord(uint32_t _allocLocationHash, void* _pAddress, uint64_t _id)
+                MemoryRecord(uint32_t _allocLocationHash, void* _pAddress, size_t _size, uint64_t _id)
                     : allocLocationHash(_allocLocationHash)
                     , pAddress(_pAddress)
+                    , size(_size)
                     , id(_id)
                 {
                     //
@@ -155,34 +336,59 @@
             };
 
             #if BLEACH_NEW_USE_EASTL
-                using Counts = eastl::hash_map<uint32_t, CountRecord, eastl::hash<uint32_t>, eastl::equal_to<uint32_t>, RawEastlAllocator>;
-                using Records = eastl::hash_map<size_t, MemoryRecord, eastl::hash<size_t>, eastl::equal_to<size_t>, RawEastlAllocator>;
+                using Counts = eastl::hash_map<uint32_t, CountRecord, eastl::hash<uint32_t>, eastl::equal_to<uint32_t>, ArenaEastlAllocator>;
+                using Records = eastl::hash_map<size_t, MemoryRecord, eastl::hash<size_t>, eastl::equal_to<size_t>, ArenaEastlAllocator>;
             #else
-                using Counts = std::unordered_map<uint32_t, CountRecord>;
-                using Records = std::unordered_map<size_t, MemoryRecord>;
+                using Counts = std::unordered_map<uint32_t, CountRecord, std::hash<uint32_t>, std::equal_to<uint32_t>, ArenaStlAllocator<std::pair<const uint32_t, CountRecord>>>;
+                using Records = std::unordered_map<size_t, MemoryRecord, std::hash<size_t>, std::equal_to<size_t>, ArenaStlAllocator<std::pair<const size_t, MemoryRecord>>>;
             #endif  // BLEACH_NEW_USE_EASTL
 
+            // The hash maps are constructed inside the arena and never destroyed.  Releasing the arena throws away 
+            // every node in one go, which is much faster than tearing the maps down one record at a time.
+            struct Storage
+            {
+                Counts counts;
+                Records records;
+            };
 
-            Counts m_counts;  // memory hash => CountRecord
-            Records m_records;  // pointer => MemoryRecord
+            Storage& m_storage;
+            Counts& m_counts;  // memory hash => CountRecord
+            Records& m_records;  // pointer => MemoryRecord
             std::recursive_mutex m_mutex;
             std::atomic_bool m_destroying;
+            // Upper limits for the size settings.  Every map entry costs well over 64 bytes, so a bigger count could 
+            // never be satisfied anyway.
+            static constexpr size_t kMaxReservedEntries = SIZE_MAX / 64;
+            static constexpr size_t kMaxArenaSize = SIZE_MAX / 2;
+
+            uint64_t m_recordRehashes;  // number of times the records map had to grow its bucket array
+            uint64_t m_callSiteRehashes;  // number of times the counts map had to grow its bucket array
+            size_t m_peakRecords;  // highest number of live records seen at once
 
         public:
             MemoryDebugger()
-                : m_destroying(false)
+                : m_storage(CreateStorage())
+                , m_counts(m_storage.counts)
+                , m_records(m_storage.records)
+                , m_destroying(false)
+                , m_recordRehashes(0)
+                , m_callSiteRehashes(0)
+                , m_peakRecords(0)
             {
-                // find() crashes if the bucket array has a zero length, so this gets around that
-                m_counts.reserve(4);
-                m_records.reserve(4);
+                // There are usually far fewer call sites than live allocations, so the two maps are sized separately.
+                const size_t reservedCallSites = ReadSizeSetting("BLEACH_NEW_RESERVED_CALL_SITES", BLEACH_NEW_RESERVED_CALL_SITES, kMaxReservedEntries);
+                const size_t reservedRecords = ReadSizeSetting("BLEACH_NEW_RESERVED_RECORDS", BLEACH_NEW_RESERVED_RECORDS, kMaxReservedEntries);
+                Reserve(m_counts, reservedCallSites, BLEACH_NEW_RESERVED_CALL_SITES, "BLEACH_NEW_RESERVED_CALL_SITES");
+                Reserve(m_records, reservedRecords, BLEACH_NEW_RESERVED_RECORDS, "BLEACH_NEW_RESERVED_RECORDS");
             }
 
             ~MemoryDebugger()
             {
                 m_destroying = true;  // *sigh*
+                g_trackerArena.Release();
             }
 
-            void AddRecord(void* pPtr, const char* filename, int lineNum, uint64_t breakPoint = 0)
+            void AddRecord(void* pPtr, size_t size, const char* filename, int lineNum, uint64_t breakPoint = 0)
             {
                 if (m_destroying)
                     return;
@@ -191,6 +397,8 @@
 
                 // generate the hash
                 const uint32_t allocHash = HashMemoryEntry(filename, lineNum);
+                const size_t countBuckets = m_counts.bucket_count();
+                const size_t recordBuckets = m_records.bucket_count();
 
                 // add or update the memory records
                 auto findIt = m_counts.find(allocHash);
@@ -202,7 +410,7 @@
                     {
                         BREAK_INTO_DEBUGGER();
                     }
-                    m_records.emplace(reinterpret_cast<size_t>(pPtr), MemoryRecord{ allocHash, pPtr, countRecord.count });
+                    m_records.emplace(reinterpret_cast<size_t>(pPtr), MemoryRecord{ allocHash, pPtr, size, countRecord.count });
                 }
                 else
                 {
@@ -211,8 +419,16 @@
                         BREAK_INTO_DEBUGGER();
                     }
                     m_counts.emplace(allocHash, CountRecord{ filename, lineNum, 1 });
-                    m_records.emplace(reinterpret_cast<size_t>(pPtr), MemoryRecord{ allocHash, pPtr, 1 });
+                    m_records.emplace(reinterpret_cast<size_t>(pPtr), MemoryRecord{ allocHash, pPtr, size, 1 });
                 }
+
+                // keep track of growth so we can tell the user how to size things
+                if (m_counts.bucket_count() != countBuckets)
+                    ++m_callSiteRehashes;
+                if (m_records.bucket_count() != recordBuckets)
+                    ++m_recordRehashes;
+                if (m_records.size() > m_peakRecords)
+                    m_peakRecords = m_records.size();
             }
 
             void RemoveRecord(void* pPtr)
@@ -223,6 +439,44 @@
                 m_records.erase(reinterpret_cast<size_t>(pPtr));
             }
 
+            // Called when a block was resized without moving.  The record stays where it is so that it keeps its ID 
+            // and we don't pay for an erase and re-insert.
+            void ResizeRecord(void* pPtr, size_t size)
+            {
+                if (m_destroying)
+                    return;
+                std::lock_guard<std::recursive_mutex> lock(m_mutex);
+                auto findIt = m_records.find(reinterpret_cast<size_t>(pPtr));
+                if (findIt != m_records.end())
+                    findIt->second.size = size;
+            }
+
+            // Called when a block was moved to a new address.  The record keeps its source and ID so that a leaked 
+            // block reports the same thing no matter whether it was resized in place or not.  If the old block was 
+            // never tracked, a new record is made for the new block instead.
+            void MoveRecord(void* pOldPtr, void* pNewPtr, size_t size, const char* filename, int lineNum)
+            {
+                if (m_destroying)
+                    return;
+
+                std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+                auto findIt = m_records.find(reinterpret_cast<size_t>(pOldPtr));
+                if (findIt == m_records.end())
+                {
+                    AddRecord(pNewPtr, size, filename, lineNum);
+                    return;
+                }
+
+                const MemoryRecord oldRecord = findIt->second;
+                m_records.erase(findIt);
+
+                const size_t recordBuckets = m_records.bucket_count();
+                m_records.emplace(reinterpret_cast<size_t>(pNewPtr), MemoryRecord{ oldRecord.allocLocationHash, pNewPtr, size, oldRecord.id });
+                if (m_records.bucket_count() != recordBuckets)
+                    ++m_recordRehashes;
+            }
+
             void DumpMemoryRecords()
             {
                 static constexpr size_t kBufferLength = 256;
@@ -246,16 +500,114 @@
                     std::memset(buffer, 0, kBufferLength);
                     auto findIt = m_counts.find(record.allocLocationHash);
                     if (findIt != m_counts.end())
-                        InternalSprintf(buffer, kBufferLength, "%llu> %s(%d)\n    => [0x%x] ID: %llu\n", rowNum, findIt->second.filename.c_str(), findIt->second.line, address, record.id);
+                        InternalSprintf(buffer, kBufferLength, "%llu> %s(%d)\n    => [0x%x] ID: %llu, %zu bytes\n", rowNum, findIt->second.filename.c_str(), findIt->second.line, address, record.id, record.size);
                     else
-                        InternalSprintf(buffer, kBufferLength, "%llu> (No Record)\n    => [0x%x] ID: %llu\n", rowNum, address, record.id);
+                        InternalSprintf(buffer, kBufferLength, "%llu> (No Record)\n    => [0x%x] ID: %llu, %zu bytes\n", rowNum, address, record.id, record.size);
                     ::OutputDebugStringA(buffer);
                     ++rowNum;
                 }
                 ::OutputDebugStringA("========================================\n");
             }
 
+            // Sets up the arena the memory debugger lives in.  A bad BLEACH_NEW_ARENA_SIZE shouldn't take the whole 
+            // process down, so if that size can't be reserved we fall back to the compiled in size and then to the 
+            // smallest chunk the arena will make.  Returns false if even that fails, in which case tracking is off.
+            static bool InitStorage()
+            {
+                const size_t arenaSize = ReadSizeSetting("BLEACH_NEW_ARENA_SIZE", BLEACH_NEW_ARENA_SIZE, kMaxArenaSize);
+                if (g_trackerArena.Init(arenaSize))
+                    return true;
+
+                ::OutputDebugStringA("Couldn't reserve BLEACH_NEW_ARENA_SIZE bytes for the tracker, falling back to a smaller arena.\n");
+                if (g_trackerArena.Init(BLEACH_NEW_ARENA_SIZE) || g_trackerArena.Init(0))
+                    return true;
+
+                ::OutputDebugStringA("Couldn't create the tracker arena, allocation tracking is disabled.\n");
+                return false;
+            }
+
+            void DumpStorageStats()
+            {
+                static constexpr size_t kBufferLength = 256;
+
+                if (m_destroying)
+                    return;
+
+                std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+                char buffer[kBufferLength];
+                std::memset(buffer, 0, kBufferLength);
+                InternalSprintf(buffer, kBufferLength, "Tracker storage: %zu peak records, %zu call sites, %llu record rehashes, %llu call site rehashes, %llu arena growths, %zu arena bytes high-water of %zu reserved.\n", 
+                    m_peakRecords, m_counts.size(), m_recordRehashes, m_callSiteRehashes, g_trackerArena.GetGrowthCount(), g_trackerArena.GetHighWaterBytes(), g_trackerArena.GetBytesReserved());
+                ::OutputDebugStringA(buffer);
+
+                if (m_recordRehashes > 0)
+                    ::OutputDebugStringA("Consider raising BLEACH_NEW_RESERVED_RECORDS.\n");
+                if (m_callSiteRehashes > 0)
+                    ::OutputDebugStringA("Consider raising BLEACH_NEW_RESERVED_CALL_SITES.\n");
+                if (g_trackerArena.GetGrowthCount() > 0)
+                    ::OutputDebugStringA("Consider raising BLEACH_NEW_ARENA_SIZE.\n");
+            }
+
         private:
+            // InitStorage() must have succeeded first.  The first chunk is always big enough to hold the Storage.
+            static Storage& CreateStorage()
+            {
+                void* pMemory = g_trackerArena.Allocate(sizeof(Storage));
+                return *new(pMemory) Storage;
+            }
+
+            // Reserves buckets for the requested number of entries.  If that can't be done, falls back to 
+            // defaultCount and finally to a handful of buckets, since find() crashes if the bucket array has a zero 
+            // length.  A failure is logged rather than thrown so that a bad setting can't kill the process.
+            template <class Map>
+            static void Reserve(Map& map, size_t count, size_t defaultCount, const char* settingName)
+            {
+                static constexpr size_t kMinReserve = 4;
+                static constexpr size_t kBufferLength = 256;
+
+                const size_t attempts[] = { count, defaultCount, kMinReserve };
+                for (size_t attempt : attempts)
+                {
+                    try
+                    {
+                        map.reserve((attempt > kMinReserve) ? attempt : kMinReserve);
+                        return;
+                    }
+                    catch (const std::exception&)  // bad_alloc, or length_error for a bucket count the map can't hold
+                    {
+                        char buffer[kBufferLength];
+                        std::memset(buffer, 0, kBufferLength);
+                        InternalSprintf(buffer, kBufferLength, "Couldn't reserve %zu entries for %s, falling back to a smaller size.\n", attempt, settingName);
+                        ::OutputDebugStringA(buffer);
+                    }
+                }
+            }
+
+            // Reads a size from the environment variable with the given name, falling back to defaultValue if it's 
+            // not set or isn't a positive number, and clamping it to maxValue.  strtoull() happily accepts a leading 
+            // '-' and wraps the result, so anything that doesn't start with a digit is rejected up front.
+            static size_t ReadSizeSetting(const char* name, size_t defaultValue, size_t maxValue)
+            {
+                static constexpr DWORD kBufferLength = 32;
+
+                char buffer[kBufferLength];
+                const DWORD length = ::GetEnvironmentVariableA(name, buffer, kBufferLength);
+                if (length == 0 || length >= kBufferLength)
+                    return defaultValue;
+
+                if (buffer[0] < '0' || buffer[0] > '9')
+                    return defaultValue;
+
+                errno = 0;
+                char* pEnd = nullptr;
+                const unsigned long long value = std::strtoull(buffer, &pEnd, 10);
+                if (pEnd == buffer || errno == ERANGE || value == 0)
+                    return defaultValue;
+
+                return (value > maxValue) ? maxValue : static_cast<size_t>(value);
+            }
+
             static uint32_t HashMemoryEntry(const char* filename, int lineNum)
             {
                 uint32_t allocHash = static_cast<uint32_t>(StringHasher()(filename));
@@ -286,7 +638,7 @@
         {
             ::OutputDebugStringA("Initializing Bleach Leak Detector.\n");
             _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
-            if (!g_pMemoryDebugger)
+            if (!g_pMemoryDebugger && MemoryDebugger::InitStorage())
                 g_pMemoryDebugger = new MemoryDebugger;  // purposefully not using the overloaded version of new
         }
 
@@ -295,6 +647,7 @@
             if (g_pMemoryDebugger)
             {
                 DumpMemoryRecords();
+                g_pMemoryDebugger->DumpStorageStats();
                 delete g_pMemoryDebugger;
                 g_pMemoryDebugger = nullptr;  // purposefully not using the overloaded version of delete
                 ::OutputDebugStringA("Exiting Bleach Leak Detector.\n");
@@ -310,10 +663,10 @@
         //---------------------------------------------------------------------------------------------------------------------
         // Internal free functions.
         //---------------------------------------------------------------------------------------------------------------------
-        static void AddRecord(void* pPtr, const char* filename, int lineNum, uint64_t breakPoint = 0)
+        static void AddRecord(void* pPtr, size_t size, const char* filename, int lineNum, uint64_t breakPoint = 0)
         {
             if (g_pMemoryDebugger)
-                g_pMemoryDebugger->AddRecord(pPtr, filename, lineNum, breakPoint);
+                g_pMemoryDebugger->AddRecord(pPtr, size, filename, lineNum, breakPoint);
         }
 
         static void RemoveRecord(void* pPtr)
@@ -321,6 +674,18 @@
             if (g_pMemoryDebugger)
                 g_pMemoryDebugger->RemoveRecord(pPtr);
         }
+
+        static void ResizeRecord(void* pPtr, size_t size)
+        {
+            if (g_pMemoryDebugger)
+                g_pMemoryDebugger->ResizeRecord(pPtr, size);
+        }
+
+        static void MoveRecord(void* pOldPtr, void* pNewPtr, size_t size, const char* filename, int lineNum)
+        {
+            if (g_pMemoryDebugger)
+                g_pMemoryDebugger->MoveRecord(pOldPtr, pNewPtr, size, filename, lineNum);
+        }
     }  // end namespace BleachNewInternal
 
 #else  // !ENABLED_MEMORY_DEBUGGING
@@ -333,8 +698,10 @@
         void InitLeakDetector() { _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF); }
         void DumpAndDestroyLeakDetector() {}
         void DumpMemoryRecords() {}
-        static void AddRecord(void*, const char*, int, uint64_t) {}
+        static void AddRecord(void*, size_t, const char*, int, uint64_t = 0) {}
         static void RemoveRecord(void*) {}
+        static void ResizeRecord(void*, size_t) {}
+        static void MoveRecord(void*, void*, size_t, const char*, int) {}
 }
 
 #endif  // ENABLE_BLEACH_ALLOCATION_TRACKING
@@ -351,12 +718,17 @@ namespace BleachNewInternal
 {
         static void* RawAlloc(size_t size, const char* filename, int lineNum) { return _malloc_dbg(size, 1, filename, lineNum); }
         static void RawFree(void* pMemory) { _free_dbg(pMemory, 1); }
+        static void* RawCalloc(size_t count, size_t size, const char* filename, int lineNum) { return _calloc_dbg(count, size, 1, filename, lineNum); }
+        static void* RawExpand(void* pMemory, size_t size, const char* filename, int lineNum) { return _expand_dbg(pMemory, size, 1, filename, lineNum); }
+        static size_t RawSize(void* pMemory) { return _msize_dbg(pMemory, 1); }
+        static void* RawAlignedAlloc(size_t size, size_t alignment, const char* filename, int lineNum) { return _aligned_malloc_dbg(size, alignment, filename, lineNum); }
+        static void RawAlignedFree(void* pMemory) { _aligned_free_dbg(pMemory); }
 }
 
     void* DebugAlloc(size_t size, const char* filename, int lineNum, uint64_t breakAtCount /*= 0*/)
 {
         void* pPtr = Internal::RawAlloc(size, filename, lineNum);
-        AddRecord(pPtr, filename, lineNum, breakAtCount);
+        AddRecord(pPtr, size, filename, lineNum, breakAtCount);
     return pPtr;
 }
 
@@ -365,6 +737,66 @@ namespace BleachNewInternal
     BleachNewInternal::RemoveRecord(pMemory);
         Internal::RawFree(pMemory);
     }
+
+    void* DebugRealloc(void* pMemory, size_t size, const char* filename, int lineNum)
+    {
+        if (!pMemory)
+        {
+            void* pPtr = Internal::RawAlloc(size, filename, lineNum);
+            if (pPtr)
+                AddRecord(pPtr, size, filename, lineNum);
+            return pPtr;
+        }
+
+        if (size == 0)
+        {
+            DebugFree(pMemory);
+            return nullptr;
+        }
+
+        // Try to grow or shrink the block in place first.  This is the common case for large blocks since the heap 
+        // can usually extend them into the neighboring pages, and it means the existing record just gets a new size.
+        if (Internal::RawExpand(pMemory, size, filename, lineNum))
+        {
+            ResizeRecord(pMemory, size);
+            return pMemory;
+        }
+
+        // The block has to move, so allocate the new one before releasing the old one.  Doing it in this order means 
+        // no other thread can be handed the old address while its record still exists, and if the allocation fails 
+        // the original block is left alone, just like realloc().  The record moves with the block so it keeps its ID.
+        void* pNewPtr = Internal::RawAlloc(size, filename, lineNum);
+        if (pNewPtr)
+        {
+            const size_t oldSize = Internal::RawSize(pMemory);
+            std::memcpy(pNewPtr, pMemory, (oldSize < size) ? oldSize : size);
+            MoveRecord(pMemory, pNewPtr, size, filename, lineNum);
+            Internal::RawFree(pMemory);
+        }
+        return pNewPtr;
+    }
+
+    void* DebugCalloc(size_t count, size_t size, const char* filename, int lineNum)
+    {
+        void* pPtr = Internal::RawCalloc(count, size, filename, lineNum);
+        if (pPtr)
+            AddRecord(pPtr, count * size, filename, lineNum);
+        return pPtr;
+    }
+
+    void* DebugAlignedAlloc(size_t size, size_t alignment, const char* filename, int lineNum, uint64_t breakAtCount /*= 0*/)
+    {
+        void* pPtr = Internal::RawAlignedAlloc(size, alignment, filename, lineNum);
+        if (pPtr)
+            AddRecord(pPtr, size, filename, lineNum, breakAtCount);
+        return pPtr;
+    }
+
+    void DebugAlignedFree(void* pMemory)
+    {
+        RemoveRecord(pMemory);
+        Internal::RawAlignedFree(pMemory);
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -381,12 +813,31 @@ void* operator new[](size_t size, const char* filename, int lineNum) { return Bl
 void operator delete[](void* pMemory) { BleachNewInternal::DebugFree(pMemory); }
 void operator delete[](void* pMemory, const char*, int) { BleachNewInternal::DebugFree(pMemory); }
 
+// aligned
+#if BLEACH_NEW_ALIGNED_NEW
+    void* operator new(size_t size, std::align_val_t alignment, const char* filename, int lineNum) { return BleachNewInternal::DebugAlignedAlloc(size, static_cast<size_t>(alignment), filename, lineNum); }
+    void operator delete(void* pMemory, std::align_val_t) { BleachNewInternal::DebugAlignedFree(pMemory); }
+    void operator delete(void* pMemory, size_t, std::align_val_t) { BleachNewInternal::DebugAlignedFree(pMemory); }
+    void operator delete(void* pMemory, std::align_val_t, const char*, int) { BleachNewInternal::DebugAlignedFree(pMemory); }
+    void* operator new[](size_t size, std::align_val_t alignment, const char* filename, int lineNum) { return BleachNewInternal::DebugAlignedAlloc(size, static_cast<size_t>(alignment), filename, lineNum); }
+    void operator delete[](void* pMemory, std::align_val_t) { BleachNewInternal::DebugAlignedFree(pMemory); }
+    void operator delete[](void* pMemory, size_t, std::align_val_t) { BleachNewInternal::DebugAlignedFree(pMemory); }
+    void operator delete[](void* pMemory, std::align_val_t, const char*, int) { BleachNewInternal::DebugAlignedFree(pMemory); }
+#endif  // BLEACH_NEW_ALIGNED_NEW
+
 // memory tracking
 #if ENABLE_BLEACH_ALLOCATION_TRACKING
     void* operator new(size_t size, const char* filename, int lineNum, uint64_t count) {return BleachNewInternal::DebugAlloc(size, filename, lineNum, count); }
     void* operator new[](size_t size, const char* filename, int lineNum, uint64_t count) { return BleachNewInternal::DebugAlloc(size, filename, lineNum, count); }
     void operator delete(void* pMemory, const char*, int, uint64_t) { BleachNewInternal::DebugFree(pMemory); }
     void operator delete[](void* pMemory, const char*, int, uint64_t) { BleachNewInternal::DebugFree(pMemory); }
+
+    #if BLEACH_NEW_ALIGNED_NEW
+        void* operator new(size_t size, std::align_val_t alignment, const char* filename, int lineNum, uint64_t count) { return BleachNewInternal::DebugAlignedAlloc(size, static_cast<size_t>(alignment), filename, lineNum, count); }
+        void* operator new[](size_t size, std::align_val_t alignment, const char* filename, int lineNum, uint64_t count) { return BleachNewInternal::DebugAlignedAlloc(size, static_cast<size_t>(alignment), filename, lineNum, count); }
+        void operator delete(void* pMemory, std::align_val_t, const char*, int, uint64_t) { BleachNewInternal::DebugAlignedFree(pMemory); }
+        void operator delete[](void* pMemory, std::align_val_t, const char*, int, uint64_t) { BleachNewInternal::DebugAlignedFree(pMemory); }
+    #endif  // BLEACH_NEW_ALIGNED_NEW
 #endif  // ENABLE_BLEACH_ALLOCATION_TRACKING
 
 #endif  // USE_DEBUG_BLEACH_NEW
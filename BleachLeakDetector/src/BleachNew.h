@@ -32,6 +32,9 @@
 #if USE_DEBUG_BLEACH_NEW
 
         #include <cstdint>
+    #if BLEACH_NEW_ALIGNED_NEW
+        #include <new>
+    #endif
 
     //-----------------------------------------------------------------------------------------------------------------
     // Internal interface used by the macros below.  These should not be called directly; call the macros instead.
@@ -42,6 +45,10 @@
         void DumpAndDestroyLeakDetector();
         void* DebugAlloc(size_t size, const char* filename, int lineNum, uint64_t breakAtCount = 0);  // 0 means no breakpoint
         void DebugFree(void* pMemory);
+        void* DebugRealloc(void* pMemory, size_t size, const char* filename, int lineNum);
+        void* DebugCalloc(size_t count, size_t size, const char* filename, int lineNum);
+        void* DebugAlignedAlloc(size_t size, size_t alignment, const char* filename, int lineNum, uint64_t breakAtCount = 0);  // 0 means no breakpoint
+        void DebugAlignedFree(void* pMemory);
     }
 
     //-----------------------------------------------------------------------------------------------------------------
@@ -58,6 +65,18 @@
     void operator delete[](void* pMemory);
     void operator delete[](void* pMemory, const char*, int);
 
+    // aligned new / delete, used automatically by BLEACH_NEW and BLEACH_NEW_ARRAY for over-aligned types
+    #if BLEACH_NEW_ALIGNED_NEW
+        void* operator new(size_t size, std::align_val_t alignment, const char* filename, int lineNum);
+        void operator delete(void* pMemory, std::align_val_t alignment);
+        void operator delete(void* pMemory, size_t size, std::align_val_t alignment);
+        void operator delete(void* pMemory, std::align_val_t alignment, const char*, int);
+        void* operator new[](size_t size, std::align_val_t alignment, const char* filename, int lineNum);
+        void operator delete[](void* pMemory, std::align_val_t alignment);
+        void operator delete[](void* pMemory, size_t size, std::align_val_t alignment);
+        void operator delete[](void* pMemory, std::align_val_t alignment, const char*, int);
+    #endif  // BLEACH_NEW_ALIGNED_NEW
+
     //-----------------------------------------------------------------------------------------------------------------
     // Initialization & Destruction.  Call INIT_LEAK_DETECTOR() at the top of main() and DESTROY_LEAK_DETECTOR() at 
     // the bottom of main().
@@ -79,17 +98,31 @@
     //                      constructors will be called, so if you need to construct something in this block, you 
     //                      will need to use placement new.  It looks like this:
     //                          void* pRawMem = BLEACH_ALLOC(sizeInBytes);
+    // BLEACH_CALLOC:       Like BLEACH_ALLOC, but allocates count * size bytes and zeroes them, like calloc().
+    //                          int* pZeroes = static_cast<int*>(BLEACH_CALLOC(count, sizeof(int)));
+    // BLEACH_REALLOC:      Resizes a block from BLEACH_ALLOC, BLEACH_CALLOC, or BLEACH_REALLOC, like realloc().  If 
+    //                      the block can be resized in place, its existing record is kept; otherwise the record moves 
+    //                      to the new block.  On failure, nullptr is returned and the original block is untouched.
+    //                          pRawMem = BLEACH_REALLOC(pRawMem, newSizeInBytes);
+    // BLEACH_ALIGNED_ALLOC: Allocates a raw block of memory aligned to the given power of two.  You don't need this 
+    //                      for over-aligned types; BLEACH_NEW handles those for you.
+    //                          void* pSimdMem = BLEACH_ALIGNED_ALLOC(sizeInBytes, 32);
     // BLEACH_DELETE:       Scalar form of delete.  The counterpart to BLEACH_NEW.
     // BLEACH_DELETE_ARRAY: Array form of delete.  The counterpart to BLEACH_NEW_ARRAY.
-    // BLEACH_FREE:         Destroys a raw block of memory allocated with BLEACH_ALLOC.  Note that no destructors are 
-    //                      called, so you will have to do this manually.
+    // BLEACH_FREE:         Destroys a raw block of memory allocated with BLEACH_ALLOC, BLEACH_CALLOC, or 
+    //                      BLEACH_REALLOC.  Note that no destructors are called, so you will have to do this manually.
+    // BLEACH_ALIGNED_FREE: Destroys a raw block of memory allocated with BLEACH_ALIGNED_ALLOC.
     //-----------------------------------------------------------------------------------------------------------------
     #define BLEACH_NEW(_type_) new(__FILE__, __LINE__) _type_
     #define BLEACH_NEW_ARRAY(_type_, _size_) new(__FILE__, __LINE__) _type_[_size_]
     #define BLEACH_ALLOC(_size_) BleachNewInternal::DebugAlloc(_size_, __FILE__, __LINE__)
+    #define BLEACH_CALLOC(_count_, _size_) BleachNewInternal::DebugCalloc(_count_, _size_, __FILE__, __LINE__)
+    #define BLEACH_REALLOC(_ptr_, _size_) BleachNewInternal::DebugRealloc(_ptr_, _size_, __FILE__, __LINE__)
+    #define BLEACH_ALIGNED_ALLOC(_size_, _alignment_) BleachNewInternal::DebugAlignedAlloc(_size_, _alignment_, __FILE__, __LINE__)
     #define BLEACH_DELETE(_ptr_) delete _ptr_
     #define BLEACH_DELETE_ARRAY(_ptr_) delete[] _ptr_
     #define BLEACH_FREE(_ptr_) BleachNewInternal::DebugFree(_ptr_)
+    #define BLEACH_ALIGNED_FREE(_ptr_) BleachNewInternal::DebugAlignedFree(_ptr_)
 
     //-----------------------------------------------------------------------------------------------------------------
     // Memory tracking.
@@ -106,12 +139,20 @@
         void operator delete(void* pMemory, const char*, int, uint64_t);
         void operator delete[](void* pMemory, const char*, int, uint64_t);
 
+        #if BLEACH_NEW_ALIGNED_NEW
+            void* operator new(size_t size, std::align_val_t alignment, const char* filename, int lineNum, uint64_t count);
+            void* operator new[](size_t size, std::align_val_t alignment, const char* filename, int lineNum, uint64_t count);
+            void operator delete(void* pMemory, std::align_val_t alignment, const char*, int, uint64_t);
+            void operator delete[](void* pMemory, std::align_val_t alignment, const char*, int, uint64_t);
+        #endif  // BLEACH_NEW_ALIGNED_NEW
+
         // The BREAK versions of the macros work just like the non-break versions except that the debugger will break when 
         // the count (last param) is reached.  This allows you to break on the specific allocation that's causing the leak.
         // See the example for details.
         #define BLEACH_NEW_BREAK(_type_, _count_) new(__FILE__, __LINE__, _count_) _type_
         #define BLEACH_NEW_ARRAY_BREAK(_type_, _size_, _count_) new(__FILE__, __LINE__, _count_) _type_[_size_]
         #define BLEACH_ALLOC_BREAK(_size_, _count_) BleachNewInternal::DebugAlloc(_size_, __FILE__, __LINE__, _count_)
+        #define BLEACH_ALIGNED_ALLOC_BREAK(_size_, _alignment_, _count_) BleachNewInternal::DebugAlignedAlloc(_size_, _alignment_, __FILE__, __LINE__, _count_)
 
         // You can call this to dump the current allocations if you want.  It's not required or used anywhere 
         // in the system.
@@ -122,23 +163,41 @@
         #define BLEACH_NEW_BREAK(_type_, _count_) BLEACH_NEW(_type_)
         #define BLEACH_NEW_ARRAY_BREAK(_type_, _size_, _count_) BLEACH_NEW_ARRAY(_type_, _size_)
         #define BLEACH_ALLOC_BREAK(_size_, _count_) BLEACH_ALLOC(_size_, __FILE__, __LINE__)
+        #define BLEACH_ALIGNED_ALLOC_BREAK(_size_, _alignment_, _count_) BLEACH_ALIGNED_ALLOC(_size_, _alignment_)
         #define BLEACH_DUMP_MEMORY_RECORDS() void(0)
     #endif  // ENABLE_BLEACH_ALLOCATION_TRACKING
 
 #else  // !USE_DEBUG_BLEACH_NEW
+    #include <cstdlib>
+    #ifdef BLEACH_WINDOWS
+        #include <malloc.h>
+    #endif
+
     #define BLEACH_INIT_LEAK_DETECTOR() void(0)
     #define BLEACH_DUMP_AND_DESTROY_LEAK_DETECTOR() void(0)
     #define BLEACH_DUMP_MEMORY_RECORDS() void(0)
 
     #define BLEACH_NEW(_type_) new _type_
     #define BLEACH_NEW_ARRAY(_type_, _size_) new _type_[_size_]
-    #define BLEACH_ALLOC(_size_) ::operator new(_size_)
+    // BLEACH_ALLOC and BLEACH_FREE use malloc() and free() so that blocks can be passed to BLEACH_REALLOC.
+    #define BLEACH_ALLOC(_size_) std::malloc(_size_)
+    #define BLEACH_CALLOC(_count_, _size_) std::calloc(_count_, _size_)
+    #define BLEACH_REALLOC(_ptr_, _size_) std::realloc(_ptr_, _size_)
+    #ifdef BLEACH_WINDOWS
+        #define BLEACH_ALIGNED_ALLOC(_size_, _alignment_) _aligned_malloc(_size_, _alignment_)
+        #define BLEACH_ALIGNED_FREE(_ptr_) _aligned_free(_ptr_)
+    #else
+        // aligned_alloc() requires the size to be a multiple of the alignment, which _aligned_malloc() doesn't.
+        #define BLEACH_ALIGNED_ALLOC(_size_, _alignment_) ::aligned_alloc(_alignment_, ((_size_) + (_alignment_) - 1) & ~((_alignment_) - 1))
+        #define BLEACH_ALIGNED_FREE(_ptr_) std::free(_ptr_)
+    #endif
 
     #define BLEACH_NEW_BREAK(_type_, _count_) BLEACH_NEW(_type_)
     #define BLEACH_NEW_ARRAY_BREAK(_type_, _size_, _count_) BLEACH_NEW_ARRAY(_type_, _size_)
     #define BLEACH_ALLOC_BREAK(_size_, _count_) BLEACH_ALLOC(_size_)
+    #define BLEACH_ALIGNED_ALLOC_BREAK(_size_, _alignment_, _count_) BLEACH_ALIGNED_ALLOC(_size_, _alignment_)
 
     #define BLEACH_DELETE(_ptr_) delete _ptr_
     #define BLEACH_DELETE_ARRAY(_ptr_) delete[] _ptr_
-    #define BLEACH_FREE(_ptr_) ::operator delete(_ptr_)
+    #define BLEACH_FREE(_ptr_) std::free(_ptr_)
 #endif  // USE_DEBUG_BLEACH_NEW
@@ -58,3 +58,29 @@
 // the leak detector will use whatever containers are in the std namespace.
 //---------------------------------------------------------------------------------------------------------------------
 #define BLEACH_NEW_USE_EASTL 0
+
+//---------------------------------------------------------------------------------------------------------------------
+// Initial sizes for the allocation tracker's internal storage.  These are only used when 
+// ENABLE_BLEACH_ALLOCATION_TRACKING is set to 1.  BLEACH_NEW_RESERVED_RECORDS is the number of live allocations the 
+// records map is sized for up front, BLEACH_NEW_RESERVED_CALL_SITES is the number of distinct BLEACH_* call sites the 
+// counts map is sized for, and BLEACH_NEW_ARENA_SIZE is the number of bytes set aside for the arena that all of the 
+// tracker's storage comes from.  Any of them can be overridden at runtime by setting an environment variable with the 
+// same name.  The number of rehashes and arena growths is reported when the leak detector is destroyed, so if those 
+// are non-zero, bump the matching setting up.
+//---------------------------------------------------------------------------------------------------------------------
+#define BLEACH_NEW_RESERVED_RECORDS 4096
+#define BLEACH_NEW_RESERVED_CALL_SITES 256
+#define BLEACH_NEW_ARENA_SIZE (16 * 1024 * 1024)
+
+//---------------------------------------------------------------------------------------------------------------------
+// BLEACH_NEW_ALIGNED_NEW is 1 if the compiler supports C++ 17 aligned new (operator new with std::align_val_t).  When 
+// it's 1, over-aligned types allocated with BLEACH_NEW are tracked through the aligned debug heap.  You don't need to 
+// change this.
+//---------------------------------------------------------------------------------------------------------------------
+#ifndef BLEACH_NEW_ALIGNED_NEW
+    #if defined(__cpp_aligned_new)
+        #define BLEACH_NEW_ALIGNED_NEW 1
+    #else
+        #define BLEACH_NEW_ALIGNED_NEW 0
+    #endif
+#endif
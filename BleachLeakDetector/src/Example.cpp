@@ -79,6 +79,23 @@ int main()
     Foo* pFoo = BLEACH_NEW(Foo);
     BLEACH_DELETE(pFoo);
 
+    // Growable raw buffers.  BLEACH_REALLOC resizes the block in place when it can, which keeps the existing record 
+    // and skips the copy.  Otherwise it moves the block and its record, just like realloc().
+    char* pGrowable = static_cast<char*>(BLEACH_CALLOC(16, sizeof(char)));
+    pGrowable = static_cast<char*>(BLEACH_REALLOC(pGrowable, 4096));
+    BLEACH_FREE(pGrowable);
+
+    // Aligned raw memory, like you might use for SIMD buffers.
+    void* pSimdBuffer = BLEACH_ALIGNED_ALLOC(256, 32);
+    BLEACH_ALIGNED_FREE(pSimdBuffer);
+
+#if BLEACH_NEW_ALIGNED_NEW
+    // Over-aligned types are picked up automatically by BLEACH_NEW when compiling with C++ 17 or later.
+    struct alignas(32) SimdVector { float values[8]; };
+    SimdVector* pVector = BLEACH_NEW(SimdVector);
+    BLEACH_DELETE(pVector);
+#endif
+
     // Destroy the leak detector.  This dumps all memory leaks.
     BLEACH_DUMP_AND_DESTROY_LEAK_DETECTOR();
 